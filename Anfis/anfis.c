@@ -1,5 +1,19 @@
 #include "anfis.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Função para medir o tempo em segundos: tempo de parede com OpenMP;
+// sem OpenMP, tempo de CPU do clock(), equivalente na execução serial
+double wall_time(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
 // Função para gerar número aleatório entre min e max
 double random_double(double min, double max) {
     return min + (max - min) * ((double)rand() / RAND_MAX);
@@ -148,8 +162,12 @@ double calys(double* x, ANFISParams* params, double* w, double* y, double* b_out
 }
 
 // Função de treinamento do ANFIS
-void train_anfis(Dataset* train_data, ANFISParams* params, double* mse_history) {
+// mse_history recebe o erro acumulado durante a época, com os parâmetros ainda mudando;
+// time_history e param_history (opcionais) recebem o tempo e os parâmetros ao fim de cada época
+void train_anfis(Dataset* train_data, ANFISParams* params, double* mse_history,
+                 double* time_history, ANFISParams* param_history) {
     double w[NUM_RULES], y[NUM_RULES];
+    double start_time = wall_time();
     
     for (int epoch = 0; epoch < MAX_EPOCHS; epoch++) {
         double total_error = 0.0;
@@ -187,6 +205,8 @@ void train_anfis(Dataset* train_data, ANFISParams* params, double* mse_history)
         }
         
         mse_history[epoch] = total_error / train_data->num_samples;
+        if (time_history) time_history[epoch] = wall_time() - start_time;
+        if (param_history) param_history[epoch] = *params;
         
         // Mostrar progresso a cada 10 épocas
         if ((epoch + 1) % 10 == 0) {
@@ -195,6 +215,235 @@ void train_anfis(Dataset* train_data, ANFISParams* params, double* mse_history)
     }
 }
 
+// Índices dos parâmetros da regra j no vetor de parâmetros do Levenberg-Marquardt
+#define IDX_C(i, j) ((j) * (3 * NUM_FEATURES + 1) + (i))
+#define IDX_S(i, j) ((j) * (3 * NUM_FEATURES + 1) + NUM_FEATURES + (i))
+#define IDX_P(i, j) ((j) * (3 * NUM_FEATURES + 1) + 2 * NUM_FEATURES + (i))
+#define IDX_Q(j)    ((j) * (3 * NUM_FEATURES + 1) + 3 * NUM_FEATURES)
+
+// Função para aplicar o passo delta aos parâmetros
+static void apply_step(ANFISParams* params, const double* delta, ANFISParams* out) {
+    for (int j = 0; j < NUM_RULES; j++) {
+        for (int i = 0; i < NUM_FEATURES; i++) {
+            out->c[i][j] = params->c[i][j] + delta[IDX_C(i, j)];
+            out->s[i][j] = params->s[i][j] + delta[IDX_S(i, j)];
+            out->p[i][j] = params->p[i][j] + delta[IDX_P(i, j)];
+        }
+        out->q[j] = params->q[j] + delta[IDX_Q(j)];
+    }
+}
+
+// Função para calcular a linha do Jacobiano de calys em relação aos parâmetros
+static double calys_jacobian(double* x, ANFISParams* params, double* jac, double* b_out) {
+    double w[NUM_RULES], y[NUM_RULES];
+    double b;
+    double ys = calys(x, params, w, y, &b);
+    *b_out = b;
+    
+    // calys retorna 0 quando nenhuma regra é ativada; o gradiente também é nulo
+    if (b <= 1e-10) {
+        memset(jac, 0, NUM_PARAMS * sizeof(double));
+        return ys;
+    }
+    
+    for (int j = 0; j < NUM_RULES; j++) {
+        double dys_dw = (y[j] - ys) / b;
+        double dys_dy = w[j] / b;
+        
+        for (int i = 0; i < NUM_FEATURES; i++) {
+            double diff = x[i] - params->c[i][j];
+            double s_sq = params->s[i][j] * params->s[i][j];
+            double s_cu = s_sq * params->s[i][j];
+            
+            jac[IDX_C(i, j)] = dys_dw * w[j] * diff / s_sq;
+            jac[IDX_S(i, j)] = dys_dw * w[j] * diff * diff / s_cu;
+            jac[IDX_P(i, j)] = dys_dy * x[i];
+        }
+        jac[IDX_Q(j)] = dys_dy;
+    }
+    
+    return ys;
+}
+
+// Função para calcular o MSE do modelo e o número de amostras sem nenhuma regra ativa
+// (num_inactive é opcional)
+double dataset_mse(Dataset* data, ANFISParams* params, int* num_inactive) {
+    double total_error = 0.0;
+    int inactive = 0;
+    
+#ifdef _OPENMP
+    #pragma omp parallel for reduction(+:total_error, inactive) schedule(static)
+#endif
+    for (int k = 0; k < data->num_samples; k++) {
+        double w[NUM_RULES], y[NUM_RULES];
+        double b;
+        double error = calys(data->inputs[k], params, w, y, &b) - data->outputs[k];
+        total_error += error * error;
+        if (b <= 1e-10) inactive++;
+    }
+    
+    if (num_inactive) *num_inactive = inactive;
+    return total_error / data->num_samples;
+}
+
+// Função para montar J^T J (triângulo superior) e J^T e, com redução local por thread
+// Retorna o MSE e conta as amostras sem nenhuma regra ativa
+static double build_normal_equations(Dataset* data, ANFISParams* params,
+                                     double jtj[][NUM_PARAMS], double* jte, int* num_inactive) {
+    int num_blocks = (data->num_samples + LM_BLOCK_SIZE - 1) / LM_BLOCK_SIZE;
+    double total_error = 0.0;
+    int inactive = 0;
+    
+    memset(jtj, 0, NUM_PARAMS * sizeof(*jtj));
+    memset(jte, 0, NUM_PARAMS * sizeof(double));
+    
+#ifdef _OPENMP
+    #pragma omp parallel reduction(+:total_error, inactive)
+#endif
+    {
+        double local_jtj[NUM_PARAMS][NUM_PARAMS] = {{0}};
+        double local_jte[NUM_PARAMS] = {0};
+        double jac[NUM_PARAMS];
+        
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (int blk = 0; blk < num_blocks; blk++) {
+            int end = (blk + 1) * LM_BLOCK_SIZE;
+            if (end > data->num_samples) end = data->num_samples;
+            
+            for (int k = blk * LM_BLOCK_SIZE; k < end; k++) {
+                double b;
+                double error = calys_jacobian(data->inputs[k], params, jac, &b) - data->outputs[k];
+                total_error += error * error;
+                if (b <= 1e-10) inactive++;
+                
+                for (int a = 0; a < NUM_PARAMS; a++) {
+                    if (jac[a] == 0.0) continue;
+                    local_jte[a] += jac[a] * error;
+                    for (int c = a; c < NUM_PARAMS; c++) {
+                        local_jtj[a][c] += jac[a] * jac[c];
+                    }
+                }
+            }
+        }
+        
+#ifdef _OPENMP
+        #pragma omp critical
+#endif
+        {
+            for (int a = 0; a < NUM_PARAMS; a++) {
+                jte[a] += local_jte[a];
+                for (int c = a; c < NUM_PARAMS; c++) {
+                    jtj[a][c] += local_jtj[a][c];
+                }
+            }
+        }
+    }
+    
+    *num_inactive = inactive;
+    return total_error / data->num_samples;
+}
+
+// Função para resolver (J^T J + mu * diag(J^T J)) delta = -J^T e por Cholesky
+// Retorna 0 se a matriz amortecida não for definida positiva
+static int solve_damped(double jtj[][NUM_PARAMS], double* jte, double mu, double* delta) {
+    double l[NUM_PARAMS][NUM_PARAMS];
+    
+    // Montar a matriz amortecida (triângulo inferior) a partir do triângulo superior de J^T J
+    for (int a = 0; a < NUM_PARAMS; a++) {
+        for (int c = 0; c < a; c++) {
+            l[a][c] = jtj[c][a];
+        }
+        l[a][a] = jtj[a][a] + mu * fmax(jtj[a][a], LM_DIAG_MIN);
+    }
+    
+    // Decomposição de Cholesky: A = L L^T
+    for (int a = 0; a < NUM_PARAMS; a++) {
+        for (int c = 0; c <= a; c++) {
+            double sum = l[a][c];
+            for (int k = 0; k < c; k++) {
+                sum -= l[a][k] * l[c][k];
+            }
+            if (a == c) {
+                if (!(sum > 0.0)) return 0;
+                l[a][a] = sqrt(sum);
+            } else {
+                l[a][c] = sum / l[c][c];
+            }
+        }
+    }
+    
+    // Substituição direta (L z = -J^T e) e retroativa (L^T delta = z)
+    for (int a = 0; a < NUM_PARAMS; a++) {
+        double sum = -jte[a];
+        for (int k = 0; k < a; k++) {
+            sum -= l[a][k] * delta[k];
+        }
+        delta[a] = sum / l[a][a];
+    }
+    for (int a = NUM_PARAMS - 1; a >= 0; a--) {
+        double sum = delta[a];
+        for (int k = a + 1; k < NUM_PARAMS; k++) {
+            sum -= l[k][a] * delta[k];
+        }
+        delta[a] = sum / l[a][a];
+    }
+    
+    return 1;
+}
+
+// Função de treinamento do ANFIS por Levenberg-Marquardt (em lote)
+// mse_history, time_history e param_history (os dois últimos opcionais) descrevem
+// os parâmetros ao fim de cada época, após o passo aceito
+void train_anfis_lm(Dataset* train_data, ANFISParams* params, double* mse_history,
+                    double* time_history, ANFISParams* param_history) {
+    double jtj[NUM_PARAMS][NUM_PARAMS];
+    double jte[NUM_PARAMS], delta[NUM_PARAMS];
+    double mu = LM_MU_INIT;
+    double start_time = wall_time();
+    int converged = 0;
+    int inactive, candidate_inactive;
+    
+    for (int epoch = 0; epoch < MAX_EPOCHS; epoch++) {
+        if (!converged) {
+            double mse = build_normal_equations(train_data, params, jtj, jte, &inactive);
+            mse_history[epoch] = mse;
+            
+            // Aumentar o amortecimento até que o passo reduza o erro. Passos que deixam mais
+            // amostras sem regra ativa são rejeitados: o gradiente delas é nulo e o erro congelaria
+            while (1) {
+                ANFISParams candidate;
+                if (solve_damped(jtj, jte, mu, delta)) {
+                    apply_step(params, delta, &candidate);
+                    double candidate_mse = dataset_mse(train_data, &candidate, &candidate_inactive);
+                    if (candidate_mse < mse && candidate_inactive <= inactive) {
+                        *params = candidate;
+                        mse_history[epoch] = candidate_mse;
+                        mu = fmax(mu / LM_MU_FACTOR, LM_MU_MIN);
+                        break;
+                    }
+                }
+                if (mu >= LM_MU_MAX) {
+                    converged = 1;
+                    break;
+                }
+                mu = fmin(mu * LM_MU_FACTOR, LM_MU_MAX);
+            }
+        } else {
+            mse_history[epoch] = mse_history[epoch - 1];
+        }
+        
+        if (time_history) time_history[epoch] = wall_time() - start_time;
+        if (param_history) param_history[epoch] = *params;
+        
+        // Mostrar progresso a cada 10 épocas
+        if ((epoch + 1) % 10 == 0) {
+            printf("Época %d: MSE = %.6f (mu = %.1e)\n", epoch + 1, mse_history[epoch], mu);
+        }
+    }
+}
+
 // Função para avaliar o modelo
 void evaluate_anfis(Dataset* val_data, ANFISParams* params, double* accuracy, double* error_percent) {
     double w[NUM_RULES], y[NUM_RULES];
@@ -15,6 +15,15 @@
 #define MAX_LINE_LENGTH 1024
 #define MAX_SAMPLES 10000
 
+// Constantes do treinamento Levenberg-Marquardt
+#define NUM_PARAMS (NUM_RULES * (3 * NUM_FEATURES + 1))  // c, s e p por entrada + q, para cada regra
+#define LM_MU_INIT 1e-3       // Fator de amortecimento inicial
+#define LM_MU_MIN 1e-10       // Amortecimento mínimo
+#define LM_MU_FACTOR 10.0     // Fator de ajuste do amortecimento
+#define LM_MU_MAX 1e10        // Amortecimento máximo antes de encerrar
+#define LM_DIAG_MIN 1e-9      // Piso da diagonal de J^T J usada no amortecimento
+#define LM_BLOCK_SIZE 64      // Amostras por bloco na montagem do Jacobiano
+
 // Limites para normalização
 #define MAX_SPEED 120.0
 #define MIN_SPEED 0.0
@@ -61,7 +70,12 @@ void split_data(double inputs[][NUM_FEATURES], int* outputs, int num_samples,
 void initialize_params(ANFISParams* params, double inputs[][NUM_FEATURES], int num_samples);
 double random_double(double min, double max);
 double calys(double* x, ANFISParams* params, double* w, double* y, double* b_out);
-void train_anfis(Dataset* train_data, ANFISParams* params, double* mse_history);
+void train_anfis(Dataset* train_data, ANFISParams* params, double* mse_history,
+                 double* time_history, ANFISParams* param_history);
+void train_anfis_lm(Dataset* train_data, ANFISParams* params, double* mse_history,
+                    double* time_history, ANFISParams* param_history);
+double dataset_mse(Dataset* data, ANFISParams* params, int* num_inactive);
+double wall_time(void);
 void evaluate_anfis(Dataset* val_data, ANFISParams* params, double* accuracy, double* error_percent);
 void save_params(ANFISParams* params);
 void save_results(double* mse_history, double accuracy, double error_percent);
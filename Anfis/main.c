@@ -1,6 +1,90 @@
 #include "anfis.h"
 
-int main() {
+// Função para carregar e normalizar um CSV em um Dataset
+static int load_dataset(const char* filename, DataPoint* raw_data, Dataset* dataset) {
+    int num_samples = load_data(filename, raw_data);
+    if (num_samples <= 0) {
+        return num_samples;
+    }
+    
+    normalize_data(raw_data, num_samples, dataset->inputs);
+    for (int i = 0; i < num_samples; i++) {
+        dataset->outputs[i] = raw_data[i].cluster_id;
+    }
+    dataset->num_samples = num_samples;
+    return num_samples;
+}
+
+// Função para encontrar a primeira época que atinge o MSE alvo (-1 se nenhuma)
+static int epoch_to_target(double* mse_history, double target_mse) {
+    for (int epoch = 0; epoch < MAX_EPOCHS; epoch++) {
+        if (mse_history[epoch] <= target_mse) return epoch;
+    }
+    return -1;
+}
+
+// Função para comparar o tempo até o MSE alvo entre SGD e Levenberg-Marquardt
+// O MSE de cada época é recalculado depois do treino, em lote, a partir dos parâmetros
+// salvos ao fim da época, com a mesma definição para os dois métodos e fora da medição de tempo
+static void benchmark_training(Dataset* train_data, ANFISParams* initial_params, double target_mse) {
+    double sgd_mse[MAX_EPOCHS], sgd_time[MAX_EPOCHS];
+    double lm_mse[MAX_EPOCHS], lm_time[MAX_EPOCHS];
+    ANFISParams params;
+    ANFISParams* sgd_params = malloc(MAX_EPOCHS * sizeof(ANFISParams));
+    ANFISParams* lm_params = malloc(MAX_EPOCHS * sizeof(ANFISParams));
+    if (!sgd_params || !lm_params) {
+        printf("Erro ao alocar memória para histórico de parâmetros\n");
+        free(sgd_params);
+        free(lm_params);
+        return;
+    }
+    
+    printf("\nTreinamento SGD (taxa de aprendizado = %.4f)\n", ALPHA);
+    printf("----------------------------------------\n");
+    params = *initial_params;
+    train_anfis(train_data, &params, sgd_mse, sgd_time, sgd_params);
+    
+    printf("\nTreinamento Levenberg-Marquardt (mu inicial = %.1e)\n", LM_MU_INIT);
+    printf("----------------------------------------\n");
+    params = *initial_params;
+    train_anfis_lm(train_data, &params, lm_mse, lm_time, lm_params);
+    
+    for (int epoch = 0; epoch < MAX_EPOCHS; epoch++) {
+        sgd_mse[epoch] = dataset_mse(train_data, &sgd_params[epoch], NULL);
+        lm_mse[epoch] = dataset_mse(train_data, &lm_params[epoch], NULL);
+    }
+    free(sgd_params);
+    free(lm_params);
+    
+    // Sem alvo explícito, usar o MSE final do SGD
+    if (target_mse <= 0.0) {
+        target_mse = sgd_mse[MAX_EPOCHS - 1];
+    }
+    
+    printf("\n=== BENCHMARK: TEMPO ATÉ MSE <= %.6f ===\n", target_mse);
+    const char* names[2] = {"SGD", "LM"};
+    double* mse[2] = {sgd_mse, lm_mse};
+    double* times[2] = {sgd_time, lm_time};
+    for (int m = 0; m < 2; m++) {
+        int epoch = epoch_to_target(mse[m], target_mse);
+        if (epoch < 0) {
+            printf("%-4s: alvo não atingido em %d épocas (MSE final %.6f, %.4f s)\n",
+                   names[m], MAX_EPOCHS, mse[m][MAX_EPOCHS - 1], times[m][MAX_EPOCHS - 1]);
+        } else {
+            printf("%-4s: época %d, %.4f s (MSE final %.6f)\n",
+                   names[m], epoch + 1, times[m][epoch], mse[m][MAX_EPOCHS - 1]);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Modo de treinamento: "sgd" (padrão), "lm" ou "bench [mse_alvo]"
+    const char* mode = (argc > 1) ? argv[1] : "sgd";
+    if (strcmp(mode, "sgd") != 0 && strcmp(mode, "lm") != 0 && strcmp(mode, "bench") != 0) {
+        printf("Uso: %s [sgd | lm | bench [mse_alvo]]\n", argv[0]);
+        return -1;
+    }
+    
     printf("=== ANFIS em C ===\n");
     printf("Inicializando sistema...\n\n");
     
@@ -49,6 +133,14 @@ int main() {
     printf("Dividindo dados em treino e validação...\n");
     randomize_matrix();
     //split_data(normalized_inputs, outputs, num_samples, &train_data, &val_data, 0.7);
+    if (load_dataset("arquivos_csv/training.csv", raw_data, &train_data) <= 0 ||
+        load_dataset("arquivos_csv/validation.csv", raw_data, &val_data) <= 0) {
+        printf("Erro ao carregar dados de treino e validação\n");
+        free(raw_data);
+        free(normalized_inputs);
+        free(outputs);
+        return -1;
+    }
     printf("Dados de treino: %d amostras\n", train_data.num_samples);
     printf("Dados de validação: %d amostras\n", val_data.num_samples);
     
@@ -57,6 +149,14 @@ int main() {
     printf("Inicializando parâmetros do ANFIS...\n");
     initialize_params(&params, train_data.inputs, train_data.num_samples);
     
+    if (strcmp(mode, "bench") == 0) {
+        benchmark_training(&train_data, &params, (argc > 2) ? atof(argv[2]) : 0.0);
+        free(raw_data);
+        free(normalized_inputs);
+        free(outputs);
+        return 0;
+    }
+    
     // Alocar memória para histórico de MSE
     double* mse_history = malloc(MAX_EPOCHS * sizeof(double));
     if (!mse_history) {
@@ -69,15 +169,24 @@ int main() {
     
     // Treinar o modelo
     printf("\nIniciando treinamento do ANFIS...\n");
-    printf("Parâmetros: %d regras, %d épocas, taxa de aprendizado = %.4f\n", 
-           NUM_RULES, MAX_EPOCHS, ALPHA);
+    if (strcmp(mode, "lm") == 0) {
+        printf("Parâmetros: %d regras, %d épocas, Levenberg-Marquardt (mu inicial = %.1e)\n", 
+               NUM_RULES, MAX_EPOCHS, LM_MU_INIT);
+    } else {
+        printf("Parâmetros: %d regras, %d épocas, taxa de aprendizado = %.4f\n", 
+               NUM_RULES, MAX_EPOCHS, ALPHA);
+    }
     printf("----------------------------------------\n");
     
-    clock_t start_time = clock();
-    train_anfis(&train_data, &params, mse_history);
-    clock_t end_time = clock();
+    double start_time = wall_time();
+    if (strcmp(mode, "lm") == 0) {
+        train_anfis_lm(&train_data, &params, mse_history, NULL, NULL);
+    } else {
+        train_anfis(&train_data, &params, mse_history, NULL, NULL);
+    }
+    double end_time = wall_time();
     
-    double training_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    double training_time = end_time - start_time;
     printf("----------------------------------------\n");
     printf("Treinamento concluído em %.2f segundos\n\n", training_time);
     